@@ -3,20 +3,27 @@
 namespace sim_game {
 
 	void game::game_logic() {
+		m_frame_arena.reset();
+
 		m_gravity_system.update(*this);
-		m_spawn_system.update(*this);
+		m_spawn_system.update(*this, m_frame_arena);
+		m_orbit_prediction_system.update(*this);
+		m_telemetry_system.update(*this);
 	}
 
 	void game::game_draw([[maybe_unused]] const sdl::renderer& renderer)
 	{
 		m_points_render_system.update(*this);
+		m_orbit_prediction_system.draw(*this);
 		m_ui_info_system.update(*this);
+		m_orbit_prediction_system.set_target(m_ui_info_system.get_mouse_over());
 	}
 
 	void game::handle_event(SDL_Event event)
 	{
 		m_spawn_system.handle_event(*this, event);
 		m_ui_info_system.handle_event(*this, event);
+		m_telemetry_system.handle_event(*this, event);
 	}
 
 	void game::game_preload()
@@ -24,5 +31,6 @@ namespace sim_game {
 		m_ui_info_system.setup(*this);
 		m_spawn_system.setup(*this);
 		m_points_render_system.setup(*this);
+		m_orbit_prediction_system.setup(*this, m_gravity_system);
 	}
 }
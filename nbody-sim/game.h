@@ -6,6 +6,9 @@
 #include "systems/gravity_system.h"
 #include "systems/spawn_system.h"
 #include "systems/ui_info_system.h"
+#include "systems/orbit_prediction_system.h"
+#include "systems/telemetry_system.h"
+#include "util/frame_arena.h"
 
 namespace sim_game {
 	struct game : sgw::game {
@@ -23,6 +26,9 @@ namespace sim_game {
 		systems::spawn_system m_spawn_system;
 		systems::ui_info_system m_ui_info_system;
 		systems::gravity_system m_gravity_system;
+		systems::orbit_prediction_system m_orbit_prediction_system;
+		systems::telemetry_system m_telemetry_system;
+		util::frame_arena m_frame_arena;
 		glm::vec2 m_midpoint;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,412 @@
+#pragma once
+#include <sgw/sgw.h>
+#include <sgw/game.h>
+#include <glm/gtx/norm.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "gravity_system.h"
+#include "../components/physics2d.h"
+#include "../components/camera_focus.h"
+#include "../components/camera.h"
+
+namespace sim_game::systems {
+	struct orbit_prediction_system {
+		using tranform2d = sgw::components::transform2d;
+		using physics2d = components::physics2d;
+
+		constexpr static float default_prediction_time{ 20.F };
+		constexpr static float default_sample_interval{ 0.1F };
+		constexpr static float default_attractor_mass{ 1.E12F };
+		constexpr static float default_divergence_tolerance{ 5.F };
+		constexpr static std::size_t default_max_refinement{ 4 };
+		constexpr static std::size_t default_steps_per_chunk{ 512 };
+
+		orbit_prediction_system() = default;
+		orbit_prediction_system(const orbit_prediction_system&) = delete;
+		orbit_prediction_system& operator=(const orbit_prediction_system&) = delete;
+
+		~orbit_prediction_system() {
+			{
+				std::lock_guard<std::mutex> guard(m_mutex);
+				m_stop = true;
+			}
+
+			m_wake.notify_one();
+
+			if (m_worker.joinable()) {
+				m_worker.join();
+			}
+		}
+
+		void update(sgw::game& game) {
+			auto& registry = game.get_entity_registry();
+
+			if (!registry.valid(m_target) || !registry.has<tranform2d, physics2d>(m_target)) {
+				if (m_snapshot_target != entt::null) {
+					cancel();
+				}
+
+				return;
+			}
+
+			if (m_target != m_snapshot_target) {
+				clear_path();
+				submit(registry);
+				return;
+			}
+
+			auto dt = game.get_delta_time();
+			m_elapsed += dt;
+			m_path_elapsed += dt;
+			m_shared_elapsed.store(m_elapsed, std::memory_order_relaxed);
+			m_wake.notify_one();
+
+			refresh_path();
+
+			if (m_path_id == m_snapshot_id && has_diverged(registry.get<tranform2d>(m_target).get_position())) {
+				submit(registry);
+			}
+		}
+
+		void draw(sgw::game& game) {
+			auto& registry = game.get_entity_registry();
+
+			if (m_snapshot_target == entt::null || !registry.valid(m_snapshot_target) || m_path.empty()) {
+				return;
+			}
+
+			const auto& renderer = game.get_renderer();
+
+			auto midpoint = renderer.get_output_size_f<glm::vec2>() * 0.5F;
+			auto focus_id = registry.view<components::camera_focus>().front();
+			auto camera_id = registry.view<components::camera>().front();
+			const auto& focus_transform = registry.get<tranform2d>(focus_id);
+			const auto& camera_transform = registry.get<tranform2d>(camera_id);
+
+			auto camera_offset = midpoint - camera_transform.get_position();
+
+			auto offset = (midpoint - camera_offset) - focus_transform.get_position();
+
+			const auto& color = registry.get<SDL_Color>(m_snapshot_target);
+			auto line_color = SDL_Color{ color.r, color.g, color.b, 96 };
+
+			auto first = std::max(m_path_base, static_cast<std::size_t>(std::ceil(m_path_elapsed / m_sample_interval)));
+			auto last = std::min(m_path_base + m_path.size(), static_cast<std::size_t>((m_path_elapsed + m_prediction_time) / m_sample_interval) + 1);
+
+			glm::vec2 from = registry.get<tranform2d>(m_snapshot_target).get_position() + offset;
+
+			for (std::size_t i = first; i < last; i++)
+			{
+				glm::vec2 to = m_path[i - m_path_base] + offset;
+				renderer.draw_line_f(SDL_FPoint{ from.x, from.y }, SDL_FPoint{ to.x, to.y }, line_color);
+				from = to;
+			}
+		}
+
+		void setup([[maybe_unused]] sgw::game& game, const gravity_system& gravity) {
+			m_gravity = &gravity;
+			m_worker = std::thread(&orbit_prediction_system::run_worker, this);
+		}
+
+		void set_target(entt::entity target) noexcept { m_target = target; }
+		[[nodiscard]] entt::entity get_target() const noexcept { return m_target; }
+
+		[[nodiscard]] float get_prediction_time() const noexcept { return m_prediction_time; }
+		void set_prediction_time(float prediction_time) noexcept { m_prediction_time = prediction_time; }
+
+		[[nodiscard]] float get_attractor_mass() const noexcept { return m_attractor_mass; }
+		void set_attractor_mass(float attractor_mass) noexcept { m_attractor_mass = attractor_mass; }
+
+		[[nodiscard]] float get_divergence_tolerance() const noexcept { return m_divergence_tolerance; }
+		void set_divergence_tolerance(float tolerance) noexcept { m_divergence_tolerance = tolerance; }
+
+	private:
+		struct body_state {
+			tranform2d transform;
+			physics2d physics;
+		};
+
+		// Frozen copy of the hovered body and the far-field attractors it is integrated against.
+		struct snapshot {
+			std::uint64_t id = 0;
+			bool active = false;
+			float sample_interval = default_sample_interval;
+			std::size_t window_samples = 0;
+			gravity_system gravity;
+			body_state target;
+			std::vector<body_state> attractors;
+		};
+
+		// Integration state at the start of `sample`, advanced at 2^level steps per sample.
+		struct pass {
+			snapshot bodies;
+			std::size_t level = 0;
+			std::size_t steps_per_sample = 1;
+			std::size_t sample = 0;
+		};
+
+		const gravity_system* m_gravity = nullptr;
+		entt::entity m_target = entt::null;
+		entt::entity m_snapshot_target = entt::null;
+		std::uint64_t m_snapshot_id = 0;
+		float m_elapsed = 0.F;
+
+		float m_prediction_time = default_prediction_time;
+		float m_sample_interval = default_sample_interval;
+		float m_attractor_mass = default_attractor_mass;
+		float m_divergence_tolerance = default_divergence_tolerance;
+
+		// The drawn window keeps showing the previous snapshot's path until the first publish for a new one.
+		std::vector<glm::vec2> m_path;
+		std::size_t m_path_base = 0;
+		float m_path_elapsed = 0.F;
+		std::uint64_t m_path_id = 0;
+		std::uint64_t m_path_generation = 0;
+
+		std::thread m_worker;
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		bool m_stop = false;
+		snapshot m_request;
+		std::atomic<float> m_shared_elapsed{ 0.F };
+
+		std::mutex m_published_mutex;
+		std::vector<glm::vec2> m_published;
+		std::size_t m_published_base = 0;
+		std::uint64_t m_published_id = 0;
+		std::uint64_t m_published_generation = 0;
+
+		void submit(entt::registry& registry) {
+			m_snapshot_target = m_target;
+			m_elapsed = 0.F;
+
+			{
+				std::lock_guard<std::mutex> guard(m_mutex);
+
+				m_request.id++;
+				m_request.active = true;
+				m_request.sample_interval = m_sample_interval;
+				m_request.window_samples = static_cast<std::size_t>(std::ceil(m_prediction_time / m_sample_interval));
+				m_request.gravity = *m_gravity;
+				m_request.target = body_state{ registry.get<tranform2d>(m_target), registry.get<physics2d>(m_target) };
+				m_request.attractors.clear();
+
+				registry.view<tranform2d, physics2d>().each([&](const entt::entity e, const tranform2d& t, const physics2d& p) {
+					if (e != m_target && (p.get_mass() >= m_attractor_mass || registry.has<components::camera_focus>(e))) {
+						m_request.attractors.push_back(body_state{ t, p });
+					}
+				});
+
+				m_snapshot_id = m_request.id;
+				m_shared_elapsed.store(0.F, std::memory_order_relaxed);
+			}
+
+			m_wake.notify_one();
+		}
+
+		void cancel() {
+			m_snapshot_target = entt::null;
+			clear_path();
+
+			{
+				std::lock_guard<std::mutex> guard(m_mutex);
+				m_request.id++;
+				m_request.active = false;
+				m_request.attractors.clear();
+				m_snapshot_id = m_request.id;
+			}
+
+			m_wake.notify_one();
+		}
+
+		void clear_path() {
+			m_path.clear();
+			m_path_base = 0;
+			m_path_id = 0;
+			m_path_generation = 0;
+		}
+
+		// Picks up the latest path from the worker, skipping the frame rather than waiting if it is publishing.
+		void refresh_path() {
+			std::unique_lock<std::mutex> guard(m_published_mutex, std::try_to_lock);
+
+			if (!guard.owns_lock() || m_published_id != m_snapshot_id
+				|| (m_published_id == m_path_id && m_published_generation == m_path_generation)) {
+				return;
+			}
+
+			if (m_path_id != m_published_id) {
+				m_path_elapsed = m_elapsed;
+				m_path_id = m_published_id;
+			}
+
+			m_path.assign(m_published.begin(), m_published.end());
+			m_path_base = m_published_base;
+			m_path_generation = m_published_generation;
+		}
+
+		[[nodiscard]] bool has_diverged(const glm::vec2& position) const {
+			auto index = static_cast<std::size_t>(m_path_elapsed / m_sample_interval);
+
+			if (index < m_path_base || index + 1 >= m_path_base + m_path.size()) {
+				return false;
+			}
+
+			auto t = (m_path_elapsed / m_sample_interval) - static_cast<float>(index);
+			auto predicted = glm::mix(m_path[index - m_path_base], m_path[index + 1 - m_path_base], t);
+
+			return glm::length2(predicted - position) > m_divergence_tolerance * m_divergence_tolerance;
+		}
+
+		void integrate(snapshot& bodies, float dt) const {
+			const auto& gravity = bodies.gravity;
+			auto& attractors = bodies.attractors;
+			auto& target = bodies.target;
+
+			for (std::size_t a = 0; a < attractors.size(); a++)
+			{
+				for (std::size_t b = 0; b < attractors.size(); b++)
+				{
+					if (a == b) {
+						continue;
+					}
+
+					attractors[a].physics.add_velocity(gravity.calculate_acceleration(
+						attractors[b].transform, attractors[a].transform, attractors[a].physics, attractors[b].physics) * dt);
+				}
+
+				target.physics.add_velocity(gravity.calculate_acceleration(
+					attractors[a].transform, target.transform, target.physics, attractors[a].physics) * dt);
+			}
+
+			for (auto& attractor : attractors) {
+				attractor.transform.add_position(attractor.physics.get_velocity() * dt);
+			}
+
+			target.transform.add_position(target.physics.get_velocity() * dt);
+		}
+
+		void advance_sample(pass& current) const {
+			auto dt = current.bodies.sample_interval / static_cast<float>(current.steps_per_sample);
+
+			for (std::size_t i = 0; i < current.steps_per_sample; i++)
+			{
+				integrate(current.bodies, dt);
+			}
+
+			current.sample++;
+		}
+
+		static void start_pass(pass& current, const snapshot& from) {
+			current.bodies = from;
+			current.level = 0;
+			current.steps_per_sample = 1;
+			current.sample = 0;
+		}
+
+		// Continues from another pass's state at a (possibly different) level, reusing this pass's storage.
+		static void rebase_pass(pass& current, const pass& from, std::size_t level) {
+			current.bodies.target = from.bodies.target;
+			current.bodies.attractors.assign(from.bodies.attractors.begin(), from.bodies.attractors.end());
+			current.level = level;
+			current.steps_per_sample = std::size_t{ 1 } << level;
+			current.sample = from.sample;
+		}
+
+		// Samples [first, last) still worth computing: from the one being passed now to the end of the prediction.
+		[[nodiscard]] std::pair<std::size_t, std::size_t> get_window(const snapshot& origin) const {
+			auto first = static_cast<std::size_t>(m_shared_elapsed.load(std::memory_order_relaxed) / origin.sample_interval);
+			return { first, first + origin.window_samples + 1 };
+		}
+
+		void run_worker() {
+			snapshot origin;
+			pass anchor;
+			pass current;
+			std::vector<glm::vec2> path;
+			std::size_t path_base = 0;
+			std::uint64_t generation = 0;
+
+			while (true) {
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+
+					m_wake.wait(lock, [&] {
+						return m_stop || m_request.id != origin.id
+							|| (origin.active && (current.level < default_max_refinement || current.sample < get_window(origin).second));
+					});
+
+					if (m_stop) {
+						return;
+					}
+
+					if (m_request.id != origin.id) {
+						origin = m_request;
+						start_pass(anchor, origin);
+						start_pass(current, origin);
+						path.clear();
+						path.reserve(origin.window_samples + 1);
+						path_base = 0;
+						generation = 0;
+					}
+				}
+
+				if (!origin.active) {
+					continue;
+				}
+
+				auto [window_start, window_end] = get_window(origin);
+
+				// The anchor follows the first sample still drawn; everything behind it is dropped.
+				while (anchor.sample < window_start) {
+					advance_sample(anchor);
+				}
+
+				if (path_base < window_start) {
+					auto dropped = std::min(window_start - path_base, path.size());
+					path.erase(path.begin(), path.begin() + static_cast<std::ptrdiff_t>(dropped));
+					path_base = window_start;
+				}
+
+				if (current.sample < anchor.sample) {
+					rebase_pass(current, anchor, current.level);
+				}
+
+				for (std::size_t steps = 0; steps < default_steps_per_chunk && current.sample < window_end; steps += current.steps_per_sample)
+				{
+					auto index = current.sample - path_base;
+					const auto& position = current.bodies.target.transform.get_position();
+
+					if (index < path.size()) {
+						path[index] = position;
+					}
+					else {
+						path.push_back(position);
+					}
+
+					advance_sample(current);
+				}
+
+				// Once a pass has covered the window, rerun just the window at half the step and overwrite it in place.
+				if (current.sample >= window_end && current.level < default_max_refinement) {
+					anchor.level = current.level + 1;
+					anchor.steps_per_sample = std::size_t{ 1 } << anchor.level;
+					rebase_pass(current, anchor, anchor.level);
+				}
+
+				std::lock_guard<std::mutex> guard(m_published_mutex);
+				m_published.assign(path.begin(), path.end());
+				m_published_base = path_base;
+				m_published_id = origin.id;
+				m_published_generation = ++generation;
+			}
+		}
+	};
+}
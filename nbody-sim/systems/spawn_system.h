@@ -2,9 +2,12 @@
 #include <sgw/sgw.h>
 #include <sgw/game.h>
 #include <glm/gtx/rotate_vector.hpp>
+#include <memory_resource>
+#include <vector>
 #include "../components/physics2d.h"
 #include "../components/camera_focus.h"
 #include "../components/camera.h"
+#include "../util/frame_arena.h"
 
 namespace sim_game::systems {
 	struct spawn_system {
@@ -24,10 +27,10 @@ namespace sim_game::systems {
 		}
 	public:
 
-		void update(sgw::game& game) {
+		void update(sgw::game& game, util::frame_arena& arena) {
 			auto& registry = game.get_entity_registry();
 			
-			check_despawn_and_update_midpoint(game, registry);
+			check_despawn_and_update_midpoint(game, registry, arena);
 		}
 
 		void setup(sgw::game& game) {
@@ -78,6 +81,13 @@ namespace sim_game::systems {
 
 	private:
 
+		struct body_template {
+			glm::vec2 position;
+			glm::vec2 velocity;
+			float mass;
+			SDL_Color color;
+		};
+
 		void spawn_camera(entt::registry& registry) {
 			m_camera = registry.create();
 			registry.assign<tranform2d>(m_camera, m_midpoint.x, m_midpoint.y);
@@ -99,7 +109,7 @@ namespace sim_game::systems {
 			//registry.assign<SDL_Color>(heavy_2, SDL_Color{ 255, 255, 255, 255 });
 		}
 
-		void spawn_body(entt::registry& registry, float offset_location_from_midpoint, entt::entity entity = entt::null) {
+		[[nodiscard]] body_template random_body(float offset_location_from_midpoint) const {
 			auto random_r = static_cast<unsigned char>(sgw::random::next(100, 255));
 			auto random_g = static_cast<unsigned char>(sgw::random::next(100, 255));
 			auto random_b = static_cast<unsigned char>(sgw::random::next(100, 255));
@@ -113,23 +123,43 @@ namespace sim_game::systems {
 			auto rotated_spawn_point = m_midpoint + (spawn_rotation * (30.F + (10.F * offset_location_from_midpoint)));
 			auto rotated_initial_velocity = glm::rotate(initial_velocity, glm::radians(random_rotation));
 
+			return body_template{ rotated_spawn_point, rotated_initial_velocity, random_mass, SDL_Color{ random_r, random_g, random_b, 255 } };
+		}
+
+		void spawn_body(entt::registry& registry, float offset_location_from_midpoint, entt::entity entity = entt::null) {
+			auto body = random_body(offset_location_from_midpoint);
+
 			if (!registry.valid(entity)) {
 				entity = registry.create();
 			}
 
-			registry.assign_or_replace<tranform2d>(entity, rotated_spawn_point.x, rotated_spawn_point.y);
-			registry.assign_or_replace<physics2d>(entity, rotated_initial_velocity.x, rotated_initial_velocity.y, random_mass);
-			registry.assign_or_replace<SDL_Color>(entity, SDL_Color{ random_r, random_g, random_b, 255 });
+			registry.assign_or_replace<tranform2d>(entity, body.position.x, body.position.y);
+			registry.assign_or_replace<physics2d>(entity, body.velocity.x, body.velocity.y, body.mass);
+			registry.assign_or_replace<SDL_Color>(entity, body.color);
 			//registry.assign_or_replace<components::camera_focus>(entity);
 		}
 
-		void check_despawn_and_update_midpoint(sgw::game& game, entt::registry& registry) {
+		// Escaped bodies are recycled by rewriting their existing component slots, outside of the view iteration.
+		void respawn_bodies(entt::registry& registry, const std::pmr::vector<entt::entity>& escaped) {
+			for (auto entity : escaped) {
+				auto body = random_body(get_random_spawn_offset());
+				auto [t, p, c] = registry.get<tranform2d, physics2d, SDL_Color>(entity);
+
+				t = tranform2d(body.position.x, body.position.y);
+				p = physics2d(body.velocity.x, body.velocity.y, body.mass);
+				c = body.color;
+			}
+		}
+
+		void check_despawn_and_update_midpoint(sgw::game& game, entt::registry& registry, util::frame_arena& arena) {
 
 			auto [w, h] = game.get_renderer().get_output_size_f();
 
 			const auto& heavy_pos = registry.get<tranform2d>(m_heavy);
 			m_midpoint = heavy_pos.get_position();
 
+			std::pmr::vector<entt::entity> escaped(&arena);
+
 			registry.view<tranform2d, physics2d>().each([&](const entt::entity e, const tranform2d& t, const physics2d& p) {
 
 				auto pos = t.get_position() - heavy_pos.get_position();
@@ -145,10 +175,12 @@ namespace sim_game::systems {
 					//	t.set_position(m_midpoint);
 					//}
 					//else {
-					spawn_body(registry, get_random_spawn_offset(), e);
+					escaped.push_back(e);
 					//}
 				}
 			});
+
+			respawn_bodies(registry, escaped);
 		}
 
 		
@@ -0,0 +1,466 @@
+#pragma once
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+#include <sgw/sgw.h>
+#include <sgw/game.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../components/physics2d.h"
+
+namespace sim_game::systems {
+
+	// Publishes body states to local TCP clients every publish_interval steps.
+	//
+	// Every frame is a little endian u32 payload length followed by the payload:
+	//   u8 version, u8 flags (bit 0: keyframe), varint frame index, varint body count,
+	//   f32 position step, f32 velocity step, then one entry per body sorted by entity id:
+	//   varint id delta, u8 body flags (bit 0: absolute), zigzag varint x, y, vx, vy, and f32 mass when absolute.
+	// Positions and velocities are quantized to the given steps. Non absolute entries are deltas against
+	// the same entity in the previous frame; bodies missing from a frame no longer exist.
+	struct telemetry_system {
+		using tranform2d = sgw::components::transform2d;
+		using physics2d = components::physics2d;
+
+		constexpr static std::uint16_t default_port{ 7777 };
+		constexpr static std::size_t default_publish_interval{ 4 };
+		constexpr static std::size_t default_max_clients{ 8 };
+		constexpr static float default_position_step{ 1.F / 16.F };
+		constexpr static float default_velocity_step{ 1.F / 256.F };
+		constexpr static std::uint8_t protocol_version{ 1 };
+
+		telemetry_system() = default;
+		telemetry_system(const telemetry_system&) = delete;
+		telemetry_system& operator=(const telemetry_system&) = delete;
+
+		~telemetry_system() {
+			stop();
+		}
+
+		void update(sgw::game& game) {
+			if (!m_running || ++m_step % m_publish_interval != 0) {
+				return;
+			}
+
+			auto& registry = game.get_entity_registry();
+
+			{
+				std::lock_guard<std::mutex> guard(m_frame_mutex);
+
+				m_pending.clear();
+
+				registry.view<tranform2d, physics2d>().each([&](const entt::entity e, const tranform2d& t, const physics2d& p) {
+					m_pending.push_back(body_sample{ static_cast<std::uint32_t>(e), t.get_position(), p.get_velocity(), p.get_mass() });
+				});
+
+				m_pending_ready = true;
+			}
+
+			m_frame_ready.notify_one();
+		}
+
+		void handle_event([[maybe_unused]] sgw::game& game, SDL_Event event) {
+			if (event.type == SDL_KEYUP && event.key.keysym.scancode == SDL_SCANCODE_T) {
+				if (m_running) {
+					stop();
+				}
+				else {
+					start();
+				}
+			}
+		}
+
+		bool start() {
+			if (m_running) {
+				return true;
+			}
+
+#ifdef _WIN32
+			WSADATA wsa_data;
+			if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+				return false;
+			}
+#endif
+
+			m_listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+			sockaddr_in address{};
+			address.sin_family = AF_INET;
+			address.sin_port = htons(m_port);
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+			int reuse = 1;
+
+			if (m_listener == invalid_socket
+				|| setsockopt(m_listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse)) != 0
+				|| bind(m_listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+				|| listen(m_listener, static_cast<int>(m_max_clients)) != 0
+				|| !set_non_blocking(m_listener)) {
+
+				close_socket(m_listener);
+				m_listener = invalid_socket;
+#ifdef _WIN32
+				WSACleanup();
+#endif
+				return false;
+			}
+
+			m_stop = false;
+			m_pending_ready = false;
+			m_step = 0;
+			m_running = true;
+			m_worker = std::thread(&telemetry_system::run_worker, this);
+
+			return true;
+		}
+
+		void stop() {
+			if (!m_running) {
+				return;
+			}
+
+			{
+				std::lock_guard<std::mutex> guard(m_frame_mutex);
+				m_stop = true;
+			}
+
+			m_frame_ready.notify_one();
+			m_worker.join();
+
+			for (auto& c : m_clients) {
+				close_socket(c.handle);
+			}
+
+			m_clients.clear();
+			close_socket(m_listener);
+			m_listener = invalid_socket;
+			m_running = false;
+
+#ifdef _WIN32
+			WSACleanup();
+#endif
+		}
+
+		[[nodiscard]] bool is_running() const noexcept { return m_running; }
+
+		[[nodiscard]] std::uint16_t get_port() const noexcept { return m_port; }
+		void set_port(std::uint16_t port) noexcept { m_port = port; }
+
+		[[nodiscard]] std::size_t get_publish_interval() const noexcept { return m_publish_interval; }
+		void set_publish_interval(std::size_t publish_interval) noexcept { m_publish_interval = std::max(std::size_t{ 1 }, publish_interval); }
+
+	private:
+#ifdef _WIN32
+		using socket_handle = SOCKET;
+		constexpr static socket_handle invalid_socket = INVALID_SOCKET;
+#else
+		using socket_handle = int;
+		constexpr static socket_handle invalid_socket = -1;
+#endif
+
+		struct body_sample {
+			std::uint32_t id;
+			glm::vec2 position;
+			glm::vec2 velocity;
+			float mass;
+		};
+
+		struct body_record {
+			std::uint32_t id;
+			std::int32_t x;
+			std::int32_t y;
+			std::int32_t vx;
+			std::int32_t vy;
+			float mass;
+		};
+
+		struct client {
+			socket_handle handle = invalid_socket;
+			std::vector<std::uint8_t> out;
+			std::size_t offset = 0;
+			bool needs_keyframe = true;
+		};
+
+		std::uint16_t m_port = default_port;
+		std::size_t m_publish_interval = default_publish_interval;
+		std::size_t m_max_clients = default_max_clients;
+		float m_position_step = default_position_step;
+		float m_velocity_step = default_velocity_step;
+		std::size_t m_step = 0;
+		bool m_running = false;
+
+		std::thread m_worker;
+		std::mutex m_frame_mutex;
+		std::condition_variable m_frame_ready;
+		std::vector<body_sample> m_pending;
+		bool m_pending_ready = false;
+		bool m_stop = false;
+
+		// Worker owned from here on.
+		socket_handle m_listener = invalid_socket;
+		std::vector<client> m_clients;
+		std::vector<body_sample> m_samples;
+		std::vector<body_record> m_current;
+		std::vector<body_record> m_previous;
+		std::vector<std::uint8_t> m_delta_frame;
+		std::vector<std::uint8_t> m_keyframe;
+		std::uint32_t m_frame_index = 0;
+		bool m_has_previous = false;
+
+		static void close_socket(socket_handle handle) {
+			if (handle == invalid_socket) {
+				return;
+			}
+#ifdef _WIN32
+			closesocket(handle);
+#else
+			close(handle);
+#endif
+		}
+
+		static bool set_non_blocking(socket_handle handle) {
+#ifdef _WIN32
+			u_long mode = 1;
+			return ioctlsocket(handle, FIONBIO, &mode) == 0;
+#else
+			auto flags = fcntl(handle, F_GETFL, 0);
+			return flags != -1 && fcntl(handle, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+		}
+
+		static bool would_block() {
+#ifdef _WIN32
+			return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+			return errno == EWOULDBLOCK || errno == EAGAIN;
+#endif
+		}
+
+		static void write_u32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+			for (int i = 0; i < 4; i++) {
+				out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+			}
+		}
+
+		static void write_f32(std::vector<std::uint8_t>& out, float value) {
+			std::uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			write_u32(out, bits);
+		}
+
+		static void write_varint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+			while (value >= 0x80) {
+				out.push_back(static_cast<std::uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+
+			out.push_back(static_cast<std::uint8_t>(value));
+		}
+
+		static void write_svarint(std::vector<std::uint8_t>& out, std::int64_t value) {
+			write_varint(out, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+		}
+
+		[[nodiscard]] static std::int32_t quantize(float value, float step) {
+			return static_cast<std::int32_t>(std::lround(value / step));
+		}
+
+		void run_worker() {
+			while (true) {
+				bool has_frame = false;
+
+				{
+					std::unique_lock<std::mutex> lock(m_frame_mutex);
+
+					m_frame_ready.wait_for(lock, std::chrono::milliseconds(50), [&] { return m_stop || m_pending_ready; });
+
+					if (m_stop) {
+						return;
+					}
+
+					// Only the newest frame is ever handed over; anything the sim wrote before we got here was overwritten.
+					if (m_pending_ready) {
+						m_samples.swap(m_pending);
+						m_pending_ready = false;
+						has_frame = true;
+					}
+				}
+
+				accept_clients();
+
+				if (has_frame) {
+					encode_frames();
+					distribute_frames();
+				}
+
+				flush_clients();
+			}
+		}
+
+		void accept_clients() {
+			while (true) {
+				auto handle = accept(m_listener, nullptr, nullptr);
+
+				if (handle == invalid_socket) {
+					return;
+				}
+
+				if (m_clients.size() >= m_max_clients || !set_non_blocking(handle)) {
+					close_socket(handle);
+					continue;
+				}
+
+				int no_delay = 1;
+				setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&no_delay), sizeof(no_delay));
+
+				auto& c = m_clients.emplace_back();
+				c.handle = handle;
+			}
+		}
+
+		void encode_frames() {
+			m_current.clear();
+
+			for (const auto& s : m_samples) {
+				m_current.push_back(body_record{
+					s.id,
+					quantize(s.position.x, m_position_step), quantize(s.position.y, m_position_step),
+					quantize(s.velocity.x, m_velocity_step), quantize(s.velocity.y, m_velocity_step),
+					s.mass });
+			}
+
+			std::sort(m_current.begin(), m_current.end(), [](const body_record& a, const body_record& b) { return a.id < b.id; });
+
+			m_frame_index++;
+
+			encode_frame(m_keyframe, true);
+
+			if (m_has_previous) {
+				encode_frame(m_delta_frame, false);
+			}
+			else {
+				m_delta_frame.assign(m_keyframe.begin(), m_keyframe.end());
+			}
+
+			m_previous.swap(m_current);
+			m_has_previous = true;
+		}
+
+		void encode_frame(std::vector<std::uint8_t>& out, bool keyframe) const {
+			out.clear();
+			write_u32(out, 0);
+
+			out.push_back(protocol_version);
+			out.push_back(keyframe ? 1 : 0);
+			write_varint(out, m_frame_index);
+			write_varint(out, m_current.size());
+			write_f32(out, m_position_step);
+			write_f32(out, m_velocity_step);
+
+			auto previous = m_previous.begin();
+			std::uint32_t last_id = 0;
+
+			for (const auto& body : m_current) {
+				while (!keyframe && previous != m_previous.end() && previous->id < body.id) {
+					++previous;
+				}
+
+				bool absolute = keyframe || previous == m_previous.end() || previous->id != body.id || previous->mass != body.mass;
+
+				write_varint(out, body.id - last_id);
+				out.push_back(absolute ? 1 : 0);
+
+				if (absolute) {
+					write_svarint(out, body.x);
+					write_svarint(out, body.y);
+					write_svarint(out, body.vx);
+					write_svarint(out, body.vy);
+					write_f32(out, body.mass);
+				}
+				else {
+					write_svarint(out, static_cast<std::int64_t>(body.x) - previous->x);
+					write_svarint(out, static_cast<std::int64_t>(body.y) - previous->y);
+					write_svarint(out, static_cast<std::int64_t>(body.vx) - previous->vx);
+					write_svarint(out, static_cast<std::int64_t>(body.vy) - previous->vy);
+				}
+
+				last_id = body.id;
+			}
+
+			auto length = static_cast<std::uint32_t>(out.size() - 4);
+
+			for (int i = 0; i < 4; i++) {
+				out[i] = static_cast<std::uint8_t>(length >> (8 * i));
+			}
+		}
+
+		// A client still busy with an older frame loses its delta chain; an unstarted stale frame is dropped
+		// outright and the client is resynchronized with the newest keyframe.
+		void distribute_frames() {
+			for (auto& c : m_clients) {
+				if (c.offset < c.out.size()) {
+					c.needs_keyframe = true;
+
+					if (c.offset > 0) {
+						continue;
+					}
+				}
+
+				const auto& frame = c.needs_keyframe ? m_keyframe : m_delta_frame;
+
+				c.out.assign(frame.begin(), frame.end());
+				c.offset = 0;
+				c.needs_keyframe = false;
+			}
+		}
+
+		void flush_clients() {
+#ifdef MSG_NOSIGNAL
+			constexpr int send_flags = MSG_NOSIGNAL;
+#else
+			constexpr int send_flags = 0;
+#endif
+
+			for (auto& c : m_clients) {
+				while (c.offset < c.out.size()) {
+					auto remaining = static_cast<int>(c.out.size() - c.offset);
+					auto sent = send(c.handle, reinterpret_cast<const char*>(c.out.data() + c.offset), remaining, send_flags);
+
+					if (sent < 0) {
+						if (!would_block()) {
+							close_socket(c.handle);
+							c.handle = invalid_socket;
+						}
+
+						break;
+					}
+
+					c.offset += static_cast<std::size_t>(sent);
+				}
+			}
+
+			m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), [](const client& c) {
+				return c.handle == invalid_socket;
+			}), m_clients.end());
+		}
+	};
+}
@@ -19,6 +19,7 @@ namespace sim_game::systems {
 			renderer.copy_f(m_help_texture, SDL_FPoint{ 10.F, 10.F });
 
 			if (!m_show_ui) {
+				m_mouse_over = entt::null;
 				return;
 			}
 
@@ -130,6 +131,8 @@ namespace sim_game::systems {
 
 		}
 
+		[[nodiscard]] entt::entity get_mouse_over() const noexcept { return m_mouse_over; }
+
 		void on_focus_added([[maybe_unused]] entt::registry& registry, entt::entity id) {
 			m_camera_focus = id;
 		}
@@ -148,7 +151,7 @@ namespace sim_game::systems {
 			const auto& font = fm.get_font(m_font_key);
 
 			m_help_texture = renderer.create_texture_from_surface(
-				font.render_solid("Press [H] to toggle UI. Click and drag to pan view.", SDL_Color{ 255, 255, 255, 255 }));
+				font.render_solid("Press [H] to toggle UI, [T] to toggle telemetry server. Click and drag to pan view.", SDL_Color{ 255, 255, 255, 255 }));
 			m_help_texture.set_alpha_mod(128);
 
 			game.get_entity_registry().on_construct<physics2d>().connect<&ui_info_system::on_object_added>(*this);
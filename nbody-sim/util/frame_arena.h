@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace sim_game::util {
+
+	// Monotonic scratch memory for a single simulation step, usable with std::pmr containers.
+	// Deallocation is a no-op and reset() rewinds the whole arena at once. Requests that do not fit
+	// spill over to the heap, and the next reset() grows the arena so a step with the same needs fits again.
+	struct frame_arena : std::pmr::memory_resource {
+		constexpr static std::size_t default_capacity{ 64 * 1024 };
+
+		explicit frame_arena(std::size_t capacity = default_capacity) : m_buffer(allocate_buffer(capacity)), m_capacity(capacity) {}
+		frame_arena(const frame_arena&) = delete;
+		frame_arena& operator=(const frame_arena&) = delete;
+
+		~frame_arena() override {
+			release_overflow();
+			release_buffer();
+		}
+
+		void reset() {
+			if (!m_overflow.empty()) {
+				release_overflow();
+
+				release_buffer();
+				m_capacity = std::max(m_capacity * 2, m_high_water);
+				m_buffer = allocate_buffer(m_capacity);
+			}
+
+			m_offset = 0;
+			m_high_water = 0;
+		}
+
+		[[nodiscard]] std::size_t get_capacity() const noexcept { return m_capacity; }
+		[[nodiscard]] std::size_t get_used() const noexcept { return m_offset; }
+		[[nodiscard]] std::size_t get_high_water() const noexcept { return m_high_water; }
+
+	private:
+		struct overflow_block {
+			void* pointer;
+			std::size_t bytes;
+			std::size_t alignment;
+		};
+
+		constexpr static std::size_t buffer_alignment{ alignof(std::max_align_t) };
+
+		std::byte* m_buffer;
+		std::size_t m_capacity;
+		std::size_t m_offset = 0;
+		std::size_t m_high_water = 0;
+		std::vector<overflow_block> m_overflow;
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+			void* pointer = m_buffer + m_offset;
+			auto space = m_capacity - m_offset;
+
+			// Align the real address; the buffer itself is only guaranteed max_align_t alignment.
+			if (std::align(alignment, bytes, pointer, space) != nullptr) {
+				m_offset = m_capacity - space + bytes;
+				m_high_water = std::max(m_high_water, m_offset);
+
+				return pointer;
+			}
+
+			pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+			m_overflow.push_back(overflow_block{ pointer, bytes, alignment });
+			m_high_water += bytes + alignment;
+
+			return pointer;
+		}
+
+		void do_deallocate([[maybe_unused]] void* pointer, [[maybe_unused]] std::size_t bytes, [[maybe_unused]] std::size_t alignment) override {}
+
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+
+		[[nodiscard]] static std::byte* allocate_buffer(std::size_t capacity) {
+			return static_cast<std::byte*>(std::pmr::new_delete_resource()->allocate(capacity, buffer_alignment));
+		}
+
+		void release_buffer() {
+			std::pmr::new_delete_resource()->deallocate(m_buffer, m_capacity, buffer_alignment);
+		}
+
+		void release_overflow() {
+			for (const auto& block : m_overflow) {
+				std::pmr::new_delete_resource()->deallocate(block.pointer, block.bytes, block.alignment);
+			}
+
+			m_overflow.clear();
+		}
+	};
+}